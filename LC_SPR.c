@@ -0,0 +1,145 @@
+#include "LC_SPR.h"
+#include <sys/movedata.h> // Para dosmemget e dosmemput, cópia de blocos da memória de vídeo
+
+// Bits do atributo limpos pela sombra, já deslocados para o byte alto da célula
+#define SOMBRA_BITS ((Word) ((INTENSO | AZUL_FUNDO | VERDE_FUNDO | VERMELHO_FUNDO) << 8))
+
+/*
+ * Cada modo de mistura é traduzido em duas máscaras de 16 bits, aplicadas à
+ * célula inteira (carácter + atributo) sem ramificações:
+ *     resultado = (ecra & manter[modo]) | (padrao & substituir[modo])
+ * Os índices 5 a 7 não correspondem a nenhum modo e comportam-se como transparentes.
+ */
+static const Word substituir[8] = {
+    0x0000, // SPR_TRANSPARENTE
+    0x00FF, // SPR_CARACTER
+    0xFF00, // SPR_ATRIBUTO
+    0xFFFF, // SPR_AMBOS
+    0x0000, // SPR_SOMBRA
+    0x0000, 0x0000, 0x0000
+};
+static const Word manter[8] = {
+    0xFFFF,                     // SPR_TRANSPARENTE
+    0xFF00,                     // SPR_CARACTER
+    0x00FF,                     // SPR_ATRIBUTO
+    0x0000,                     // SPR_AMBOS
+    (Word) (0xFFFF & ~SOMBRA_BITS), // SPR_SOMBRA
+    0xFFFF, 0xFFFF, 0xFFFF
+};
+
+/**
+ * @brief Mistura uma região rectangular de células com o conteúdo do ecrã.
+ *
+ * A região é cortada uma vez contra os limites do ecrã. Depois, para cada
+ * linha, os extremos transparentes são ignorados, o troço restante é lido da
+ * memória de vídeo num único bloco (só se algum modo precisar do fundo),
+ * misturado em memória e escrito de volta num único bloco.
+ *
+ * @param celulas Células do padrão.
+ * @param mascara Modos de mistura do padrão.
+ * @param passo 1 para percorrer os vectores, 0 para repetir a primeira entrada em toda a região.
+ * @param x Coluna do canto superior esquerdo (pode ser negativa).
+ * @param y Linha do canto superior esquerdo (pode ser negativa).
+ * @param largura Largura da região (e comprimento de cada linha dos vectores).
+ * @param altura Altura da região.
+ * @return VERDADE se alguma parte da região estiver dentro do ecrã, FALSO caso contrário.
+ */
+static Bool misturaRegiao(const Word *celulas, const Byte *mascara, int passo,
+                          int x, int y, int largura, int altura) {
+    Word linha[LARGURA]; // Troço de uma linha do ecrã a ser misturado
+    int x0 = (x < 0) ? 0 : x;
+    int y0 = (y < 0) ? 0 : y;
+    int x1 = (x + largura > LARGURA) ? LARGURA : x + largura;
+    int y1 = (y + altura > ALTURA) ? ALTURA : y + altura;
+    int i, j;
+
+    // Corte único: a partir daqui todas as coordenadas estão dentro do ecrã.
+    if (x0 >= x1 || y0 >= y1) {
+        return FALSO;
+    }
+
+    for (j = y0; j < y1; j++) {
+        // Índice, nos vectores do padrão, da primeira célula visível desta linha.
+        long base = ((long) (j - y) * largura + (x0 - x)) * passo;
+        int primeiro = -1, ultimo = -1, n;
+        Bool lerFundo = FALSO;
+        unsigned long endereco;
+
+        // Procuramos o troço útil da linha, sem as células transparentes dos extremos.
+        for (i = 0; i < x1 - x0; i++) {
+            int modo = mascara[base + i * passo] & 7;
+            if (manter[modo] == 0xFFFF) {
+                continue; // Célula transparente: não altera o ecrã
+            }
+            if (primeiro < 0) {
+                primeiro = i;
+            }
+            ultimo = i;
+        }
+        if (primeiro < 0) {
+            continue; // Linha totalmente transparente
+        }
+
+        n = ultimo - primeiro + 1;
+        base += (long) primeiro * passo;
+
+        // O ecrã só pode deixar de ser lido se todas as células do troço o
+        // substituírem por completo; uma transparente no meio também o preserva.
+        for (i = 0; i < n && lerFundo == FALSO; i++) {
+            if (manter[mascara[base + i * passo] & 7] != 0x0000) {
+                lerFundo = VERDADE;
+            }
+        }
+        endereco = ENDERECO_VIDEO + 2UL * (LARGURA * j + x0 + primeiro);
+
+        if (lerFundo == VERDADE) {
+            dosmemget(endereco, 2 * n, linha);
+            for (i = 0; i < n; i++) {
+                int modo = mascara[base + i * passo] & 7;
+                linha[i] = (Word) ((linha[i] & manter[modo]) | (celulas[base + i * passo] & substituir[modo]));
+            }
+        } else {
+            // Todas as células do troço substituem o ecrã por completo: não é preciso lê-lo.
+            for (i = 0; i < n; i++) {
+                int modo = mascara[base + i * passo] & 7;
+                linha[i] = (Word) (celulas[base + i * passo] & substituir[modo]);
+            }
+        }
+        dosmemput(linha, 2 * n, endereco);
+    }
+    return VERDADE;
+}
+
+/**
+ * @brief Estampa um padrão no ecrã, misturando cada célula segundo a máscara.
+ * @param sprite O padrão a desenhar.
+ * @param x Posição horizontal (coluna) do canto superior esquerdo (pode ser negativa).
+ * @param y Posição vertical (linha) do canto superior esquerdo (pode ser negativa).
+ * @return VERDADE se alguma parte do padrão for desenhada, FALSO caso contrário.
+ */
+Bool sprDesenha(const Sprite *sprite, int x, int y) {
+    // Verificamos se o padrão é válido antes de tocar na memória de vídeo.
+    if (sprite == (const Sprite *) 0 || sprite->celulas == (const Word *) 0 ||
+        sprite->mascara == (const Byte *) 0 || sprite->largura <= 0 || sprite->altura <= 0) {
+        return FALSO;
+    }
+    return misturaRegiao(sprite->celulas, sprite->mascara, 1, x, y, sprite->largura, sprite->altura);
+}
+
+/**
+ * @brief Aplica SPR_SOMBRA a uma região rectangular do ecrã.
+ * @param x Posição horizontal (coluna) do canto superior esquerdo (pode ser negativa).
+ * @param y Posição vertical (linha) do canto superior esquerdo (pode ser negativa).
+ * @param largura Largura da região.
+ * @param altura Altura da região.
+ * @return VERDADE se alguma parte da região for escurecida, FALSO caso contrário.
+ */
+Bool sprSombreia(int x, int y, int largura, int altura) {
+    static const Word celula = 0;         // Ignorada pela sombra
+    static const Byte modo = SPR_SOMBRA;  // Repetido em toda a região (passo 0)
+
+    if (largura <= 0 || altura <= 0) {
+        return FALSO;
+    }
+    return misturaRegiao(&celula, &modo, 0, x, y, largura, altura);
+}
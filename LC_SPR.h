@@ -0,0 +1,68 @@
+#ifndef _LC_SPRITES_H_
+#define _LC_SPRITES_H_
+
+#include "utypes.h" // Inclui o tipo Bool e outros tipos definidos pelo utilizador
+#include "LC_VID.h" // Dimensões do ecrã e bits de atributo
+
+/** #defgroup LC_SPRITES LC_SPRITES
+ * @{
+ *
+ * Sobreposição de padrões de células (cursores, selecções, sombras) com uma
+ * máscara por célula, misturados linha a linha com a memória de vídeo.
+ *
+ * <pre>
+ * Exemplo de uso:
+ * static const Word celulas[3] = { SPR_CELULA('[', NORMAL), 0, SPR_CELULA(']', NORMAL) };
+ * static const Byte mascara[3] = { SPR_AMBOS, SPR_TRANSPARENTE, SPR_AMBOS };
+ * Sprite cursor = { 3, 1, celulas, mascara };
+ * sprDesenha(&cursor, 10, 5);
+ * </pre>
+*/
+
+/** @name Modos de mistura de cada célula da máscara */
+/*@{*/
+#define SPR_TRANSPARENTE 0 ///< A célula do ecrã fica intacta
+#define SPR_CARACTER 1     ///< Substitui só o carácter, mantendo o atributo do ecrã
+#define SPR_ATRIBUTO 2     ///< Substitui só o atributo, mantendo o carácter do ecrã
+#define SPR_AMBOS (SPR_CARACTER | SPR_ATRIBUTO) ///< Substitui o carácter e o atributo
+#define SPR_SOMBRA 4       ///< Escurece o fundo: limpa INTENSO e os bits de fundo do atributo do ecrã
+/*@}*/
+
+/** Constrói uma célula de vídeo (carácter no byte baixo, atributo no byte alto) */
+#define SPR_CELULA(ch, atributos) ((Word) (((Byte) (atributos) << 8) | (Byte) (ch)))
+
+/**
+ * @brief Padrão rectangular de células com a respectiva máscara.
+ * Os vectores são percorridos por linhas e têm largura * altura entradas.
+ */
+typedef struct {
+    int largura;           ///< Número de colunas do padrão
+    int altura;            ///< Número de linhas do padrão
+    const Word *celulas;   ///< Células a estampar (ver SPR_CELULA)
+    const Byte *mascara;   ///< Modo de mistura de cada célula (SPR_*)
+} Sprite;
+
+/**
+ * @brief Estampa um padrão no ecrã, misturando cada célula segundo a máscara.
+ * O padrão é cortado uma única vez contra os limites do ecrã, podendo ficar
+ * parcialmente fora dele.
+ * @param sprite O padrão a desenhar.
+ * @param x Posição horizontal (coluna) do canto superior esquerdo (pode ser negativa).
+ * @param y Posição vertical (linha) do canto superior esquerdo (pode ser negativa).
+ * @return VERDADE se alguma parte do padrão for desenhada, FALSO caso contrário.
+ */
+Bool sprDesenha(const Sprite *sprite, int x, int y);
+
+/**
+ * @brief Aplica SPR_SOMBRA a uma região rectangular do ecrã.
+ * Útil para a sombra projectada por um quadro de drawFrame.
+ * @param x Posição horizontal (coluna) do canto superior esquerdo (pode ser negativa).
+ * @param y Posição vertical (linha) do canto superior esquerdo (pode ser negativa).
+ * @param largura Largura da região.
+ * @param altura Altura da região.
+ * @return VERDADE se alguma parte da região for escurecida, FALSO caso contrário.
+ */
+Bool sprSombreia(int x, int y, int largura, int altura);
+
+/**@} Fim do grupo LC_SPRITES */
+#endif // _LC_SPRITES_H_
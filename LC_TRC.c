@@ -0,0 +1,361 @@
+#include "LC_TRC.h"
+#include <time.h> // Para uclock (DJGPP) ou clock_gettime, quando não há rdtsc
+
+// Sem -DLC_TRACO este módulo fica vazio, para não levar os histogramas e o
+// registo de chamadas (cerca de 200 KB) para um executável sem rastreio.
+#ifdef LC_TRACO
+
+/*
+ * Histograma logarítmico-linear (estilo HDR): os valores 0 a 15 têm uma
+ * posição própria; acima disso, cada potência de 2 é dividida em 8 posições
+ * iguais, o que dá um erro relativo máximo de 12,5% em qualquer escala.
+ * Valores com mais de TRC_BITS_MAXIMOS bits vão para a última posição.
+ */
+#define SUB_BITS 3                       // log2 do número de subdivisões por potência de 2
+#define SUB_POSICOES (1 << SUB_BITS)     // Subdivisões por potência de 2
+#define LINEAR (2 * SUB_POSICOES)        // Valores guardados sem arredondamento (0 a 15)
+#define TRC_BITS_MAXIMOS 48              // 2^48 ciclos (ou ns) chegam para vários dias
+#define POSICOES (LINEAR + (TRC_BITS_MAXIMOS - SUB_BITS - 1) * SUB_POSICOES)
+
+#define CLASSES 12 // Classes de células: 1, 2-3, 4-7, ..., 2048-4095 (o ecrã tem 2000)
+
+/**
+ * @brief Contagens de um histograma de latências.
+ */
+typedef struct {
+    ulong contagem;                 // Número de chamadas registadas
+    unsigned long long maximo;      // Maior latência observada, na unidade do relógio
+    ulong posicoes[POSICOES];       // Número de chamadas em cada posição
+} Histograma;
+
+/**
+ * @brief Uma chamada guardada no registo circular.
+ */
+typedef struct {
+    unsigned long long inicio;  // Instante de entrada, na unidade do relógio
+    ulong duracao;              // Duração da chamada (saturada a 32 bits)
+    short largura, altura;      // Rectângulo tocado pela chamada
+    Byte funcao;                // Uma das constantes TRC_*
+} Evento;
+
+static const char *nomes[TRC_FUNCOES] = {
+    "printCharAt", "printStringAt", "drawFrame",
+    "printCharRepeatedAt", "clearScreen", "scrollRegion"
+};
+
+static Histograma porFuncao[TRC_FUNCOES];           // Latência de cada função
+static Histograma porClasse[TRC_FUNCOES][CLASSES];  // Latência por função e número de células
+static Evento eventos[TRC_EVENTOS];                 // Registo circular das últimas chamadas
+static ulong proximoEvento;                         // Total de chamadas registadas até agora
+static int profundidade;                            // Chamadas rastreadas actualmente abertas
+
+// Fontes de tempo possíveis, escolhidas na primeira leitura do relógio
+#define FONTE_DESCONHECIDA 0 // Ainda não foi feita a detecção
+#define FONTE_RDTSC 1        // Contador de ciclos do processador
+#define FONTE_SISTEMA 2      // uclock no DJGPP, clock_gettime nos outros sistemas
+
+static int fonte = FONTE_DESCONHECIDA; // Fonte de tempo em uso
+
+#if defined(__i386__) || defined(__x86_64__)
+/**
+ * @brief Verifica, com CPUID, se o processador tem a instrução rdtsc.
+ * O DOSBox só a aceita com cputype=pentium_slow; noutros modos rdtsc
+ * provoca uma excepção de código de operação inválido.
+ */
+static Bool temRdtsc(void) {
+    unsigned long a, b, c, d;
+#if defined(__i386__)
+    unsigned long antes, depois;
+
+    // O CPUID só existe se o bit ID (21) de EFLAGS puder ser alterado.
+    __asm__ __volatile__(
+        "pushfl\n\t"
+        "popl %0\n\t"
+        "movl %0, %1\n\t"
+        "xorl $0x200000, %0\n\t"
+        "pushl %0\n\t"
+        "popfl\n\t"
+        "pushfl\n\t"
+        "popl %0\n\t"
+        "pushl %1\n\t"
+        "popfl"
+        : "=&r"(depois), "=&r"(antes));
+    if (((antes ^ depois) & 0x200000UL) == 0) {
+        return FALSO; // Processador anterior ao CPUID
+    }
+#endif
+    __asm__ __volatile__("cpuid" : "=a"(a), "=b"(b), "=c"(c), "=d"(d) : "a"(0UL));
+    if (a < 1) {
+        return FALSO; // Sem a folha 1 não se pode consultar o bit TSC
+    }
+    __asm__ __volatile__("cpuid" : "=a"(a), "=b"(b), "=c"(c), "=d"(d) : "a"(1UL));
+    return (d & (1UL << 4)) ? VERDADE : FALSO; // Bit 4 de EDX: TSC
+}
+#endif
+
+/**
+ * @brief Lê o relógio do rastreio.
+ * Usa rdtsc (ciclos) quando o CPUID o anuncia; caso contrário, uclock no DJGPP
+ * ou o relógio monotónico (nanossegundos) nos outros sistemas.
+ */
+static unsigned long long relogio(void) {
+    if (fonte == FONTE_DESCONHECIDA) {
+#if defined(__i386__) || defined(__x86_64__)
+        fonte = (temRdtsc() == VERDADE) ? FONTE_RDTSC : FONTE_SISTEMA;
+#else
+        fonte = FONTE_SISTEMA;
+#endif
+    }
+#if defined(__i386__) || defined(__x86_64__)
+    if (fonte == FONTE_RDTSC) {
+        unsigned long baixo, alto;
+        __asm__ __volatile__("rdtsc" : "=a"(baixo), "=d"(alto));
+        return ((unsigned long long) alto << 32) | baixo;
+    }
+#endif
+#ifdef __DJGPP__
+    return (unsigned long long) uclock();
+#else
+    {
+        struct timespec agora;
+        clock_gettime(CLOCK_MONOTONIC, &agora);
+        return (unsigned long long) agora.tv_sec * 1000000000ULL + (unsigned long long) agora.tv_nsec;
+    }
+#endif
+}
+
+/**
+ * @brief Devolve o nome da unidade das durações registadas.
+ */
+const char *trcUnidade(void) {
+    if (fonte == FONTE_DESCONHECIDA) {
+        relogio(); // Força a detecção da fonte de tempo
+    }
+    if (fonte == FONTE_RDTSC) {
+        return "ciclos";
+    }
+#ifdef __DJGPP__
+    return "uclock"; // Tiques de 1/UCLOCKS_PER_SEC segundos (cerca de 0,84 us)
+#else
+    return "ns";
+#endif
+}
+
+/**
+ * @brief Devolve o índice do bit mais significativo de um valor não nulo.
+ */
+static int bitMaisAlto(unsigned long long valor) {
+    int bit = 0;
+    while (valor >>= 1) {
+        bit++;
+    }
+    return bit;
+}
+
+/**
+ * @brief Calcula a posição do histograma onde cai um valor.
+ */
+static int posicaoDe(unsigned long long valor) {
+    int bit;
+    if (valor < LINEAR) {
+        return (int) valor;
+    }
+    bit = bitMaisAlto(valor);
+    if (bit >= TRC_BITS_MAXIMOS) {
+        return POSICOES - 1;
+    }
+    // Os SUB_BITS bits abaixo do mais significativo escolhem a subdivisão.
+    return LINEAR + (bit - SUB_BITS - 1) * SUB_POSICOES +
+           (int) ((valor >> (bit - SUB_BITS)) & (SUB_POSICOES - 1));
+}
+
+/**
+ * @brief Devolve o maior valor que cai numa posição do histograma.
+ */
+static unsigned long long limiteDe(int posicao) {
+    int bit, sub;
+    if (posicao < LINEAR) {
+        return (unsigned long long) posicao;
+    }
+    bit = (posicao - LINEAR) / SUB_POSICOES + SUB_BITS + 1;
+    sub = (posicao - LINEAR) % SUB_POSICOES;
+    return (((unsigned long long) (SUB_POSICOES + sub + 1)) << (bit - SUB_BITS)) - 1;
+}
+
+/**
+ * @brief Devolve a classe de células: 0 para 0 ou 1 célula, k para 2^k a 2^(k+1)-1.
+ */
+static int classeDe(long celulas) {
+    int classe = (celulas <= 1) ? 0 : bitMaisAlto((unsigned long long) celulas);
+    return (classe >= CLASSES) ? CLASSES - 1 : classe;
+}
+
+/**
+ * @brief Acrescenta uma latência a um histograma.
+ */
+static void registaEm(Histograma *h, unsigned long long duracao) {
+    h->contagem++;
+    h->posicoes[posicaoDe(duracao)]++;
+    if (duracao > h->maximo) {
+        h->maximo = duracao;
+    }
+}
+
+/**
+ * @brief Devolve o limite superior da posição que contém o percentil pedido.
+ * @param h O histograma.
+ * @param permilagem Percentil em milésimas (500 = p50, 990 = p99).
+ */
+static unsigned long long percentil(const Histograma *h, int permilagem) {
+    ulong alvo = (ulong) (((unsigned long long) h->contagem * permilagem + 999) / 1000);
+    ulong acumulado = 0;
+    int i;
+    unsigned long long limite;
+
+    if (alvo == 0) {
+        alvo = 1;
+    }
+    for (i = 0; i < POSICOES; i++) {
+        acumulado += h->posicoes[i];
+        if (acumulado >= alvo) {
+            limite = limiteDe(i);
+            return (limite > h->maximo) ? h->maximo : limite; // Nunca acima do máximo real
+        }
+    }
+    return h->maximo;
+}
+
+/**
+ * @brief Apaga todos os histogramas e o registo de chamadas.
+ */
+void trcInicia(void) {
+    int f, c, i;
+    for (f = 0; f < TRC_FUNCOES; f++) {
+        porFuncao[f].contagem = 0;
+        porFuncao[f].maximo = 0;
+        for (i = 0; i < POSICOES; i++) {
+            porFuncao[f].posicoes[i] = 0;
+        }
+        for (c = 0; c < CLASSES; c++) {
+            porClasse[f][c].contagem = 0;
+            porClasse[f][c].maximo = 0;
+            for (i = 0; i < POSICOES; i++) {
+                porClasse[f][c].posicoes[i] = 0;
+            }
+        }
+    }
+    proximoEvento = 0;
+    profundidade = 0;
+}
+
+/**
+ * @brief Marca a entrada numa função rastreada.
+ * Chamadas aninhadas não lêem o relógio, para não pesarem na medição exterior.
+ * @return O instante de entrada na unidade do relógio, ou 0 se a chamada estiver aninhada noutra.
+ */
+unsigned long long trcEntra(void) {
+    return (profundidade++ == 0) ? relogio() : 0;
+}
+
+/**
+ * @brief Marca a saída de uma função rastreada e regista a sua duração.
+ * @param funcao Uma das constantes TRC_*.
+ * @param inicio Valor devolvido por trcEntra.
+ * @param largura Largura do rectângulo tocado pela chamada.
+ * @param altura Altura do rectângulo tocado pela chamada.
+ * @param resultado Valor que a função rastreada devolve.
+ * @return O próprio resultado, para poder ser usado num return.
+ */
+Bool trcSai(int funcao, unsigned long long inicio, int largura, int altura, Bool resultado) {
+    unsigned long long duracao;
+    ulong indice;
+    Evento *e;
+
+    if (--profundidade != 0 || funcao < 0 || funcao >= TRC_FUNCOES) {
+        return resultado; // Chamada aninhada: já conta na chamada exterior
+    }
+    duracao = relogio() - inicio;
+
+    // Argumentos inválidos podem trazer dimensões negativas.
+    if (largura < 0) largura = 0;
+    if (altura < 0) altura = 0;
+
+    registaEm(&porFuncao[funcao], duracao);
+    registaEm(&porClasse[funcao][classeDe((long) largura * altura)], duracao);
+
+    // O registo circular não usa trincos: com um só fio de execução, a posição
+    // seguinte é sempre livre e a mais antiga é simplesmente reescrita.
+    indice = proximoEvento++ & (TRC_EVENTOS - 1);
+    e = &eventos[indice];
+    e->inicio = inicio;
+    e->duracao = (duracao > 0xFFFFFFFFUL) ? 0xFFFFFFFFUL : (ulong) duracao;
+    e->largura = (short) largura;
+    e->altura = (short) altura;
+    e->funcao = (Byte) funcao;
+
+    return resultado;
+}
+
+/**
+ * @brief Grava o registo circular num ficheiro CSV, da chamada mais antiga para a mais recente.
+ * @param ficheiro Nome do ficheiro a criar.
+ * @return VERDADE se o ficheiro for gravado, FALSO caso contrário.
+ */
+Bool trcGravaCSV(const char *ficheiro) {
+    FILE *saida;
+    ulong total = proximoEvento;
+    ulong primeiro = (total > TRC_EVENTOS) ? total - TRC_EVENTOS : 0;
+    ulong i;
+
+    if (ficheiro == (const char *) 0 || (saida = fopen(ficheiro, "w")) == (FILE *) 0) {
+        return FALSO;
+    }
+    // A unidade vai no nome das colunas, para o ficheiro não ser lido com a errada.
+    fprintf(saida, "funcao,inicio_%s,duracao_%s,largura,altura\n", trcUnidade(), trcUnidade());
+    for (i = primeiro; i < total; i++) {
+        const Evento *e = &eventos[i & (TRC_EVENTOS - 1)];
+        fprintf(saida, "%s,%llu,%lu,%d,%d\n", nomes[e->funcao], e->inicio,
+                e->duracao, e->largura, e->altura);
+    }
+    return (fclose(saida) == 0) ? VERDADE : FALSO;
+}
+
+/**
+ * @brief Escreve uma linha do resumo, se o histograma tiver chamadas.
+ */
+static void escreveLinha(FILE *saida, const char *nome, const char *classe, const Histograma *h) {
+    if (h->contagem == 0) {
+        return;
+    }
+    fprintf(saida, "%-20s %-10s %8lu %10llu %10llu %10llu\n", nome, classe, h->contagem,
+            percentil(h, 500), percentil(h, 990), h->maximo);
+}
+
+/**
+ * @brief Escreve p50, p99 e máximo por função e por classe de células.
+ * @param saida Destino do resumo.
+ */
+void trcResumo(FILE *saida) {
+    char classe[16];
+    int f, c;
+
+    if (saida == (FILE *) 0) {
+        return;
+    }
+    fprintf(saida, "unidade: %s\n", trcUnidade());
+    fprintf(saida, "%-20s %-10s %8s %10s %10s %10s\n",
+            "funcao", "celulas", "chamadas", "p50", "p99", "maximo");
+    for (f = 0; f < TRC_FUNCOES; f++) {
+        escreveLinha(saida, nomes[f], "todas", &porFuncao[f]);
+        for (c = 0; c < CLASSES; c++) {
+            if (c == 0) {
+                sprintf(classe, "0-1");
+            } else {
+                sprintf(classe, "%ld-%ld", 1L << c, (1L << (c + 1)) - 1);
+            }
+            escreveLinha(saida, "", classe, &porClasse[f][c]);
+        }
+    }
+}
+
+#endif // LC_TRACO
@@ -0,0 +1,99 @@
+#ifndef _LC_TRACO_H_
+#define _LC_TRACO_H_
+
+#include <stdio.h>  // Para FILE, usado pelo resumo
+#include "utypes.h" // Inclui o tipo Bool e outros tipos definidos pelo utilizador
+
+/** #defgroup LC_TRACO LC_TRACO
+ * @{
+ *
+ * Rastreio opcional da latência de cada chamada às funções públicas de LC_VID.
+ *
+ * Só é activado quando LC_VID.c e main.c são compilados com -DLC_TRACO
+ * (make TRACO=-DLC_TRACO); caso contrário, TRC_ENTRA e TRC_RETORNA não geram
+ * código. Cada chamada feita pela aplicação é medida com o contador de ciclos
+ * do processador (rdtsc), se o CPUID o anunciar; caso contrário usa-se uclock
+ * (DJGPP) ou clock_gettime. A unidade em uso é dada por trcUnidade. Cada
+ * medição é guardada:
+ * - num histograma logarítmico-linear por função (precisão de 12,5%);
+ * - num histograma por função e por classe de número de células (1, 2-3, 4-7, ...);
+ *   drawFrame conta só as células da borda, e uma chamada rejeitada conta 0;
+ * - num registo circular de tamanho fixo com as últimas TRC_EVENTOS chamadas.
+ *
+ * Chamadas aninhadas (por exemplo, printCharAt dentro de clearScreen) fazem
+ * parte do custo da chamada exterior e não são registadas em separado.
+ *
+ * O rastreio assume um só fio de execução e não é reentrante: uma rotina de
+ * interrupção que chame LC_VID a meio de outra chamada é contada como aninhada
+ * e pode corromper os histogramas ou uma entrada do registo.
+*/
+
+/** @name Funções de LC_VID rastreadas */
+/*@{*/
+#define TRC_PRINTCHARAT 0         ///< printCharAt
+#define TRC_PRINTSTRINGAT 1       ///< printStringAt
+#define TRC_DRAWFRAME 2           ///< drawFrame
+#define TRC_PRINTCHARREPEATEDAT 3 ///< printCharRepeatedAt
+#define TRC_CLEARSCREEN 4         ///< clearScreen
+#define TRC_SCROLLREGION 5        ///< scrollRegion
+#define TRC_FUNCOES 6             ///< Número de funções rastreadas
+/*@}*/
+
+#define TRC_EVENTOS 4096 ///< Capacidade do registo circular de chamadas (potência de 2)
+
+/**
+ * @brief Apaga todos os histogramas e o registo de chamadas.
+ */
+void trcInicia(void);
+
+/**
+ * @brief Marca a entrada numa função rastreada.
+ * @return O instante de entrada na unidade do relógio, ou 0 se a chamada estiver aninhada noutra.
+ */
+unsigned long long trcEntra(void);
+
+/**
+ * @brief Marca a saída de uma função rastreada e regista a sua duração.
+ * @param funcao Uma das constantes TRC_*.
+ * @param inicio Valor devolvido por trcEntra.
+ * @param largura Largura do rectângulo tocado pela chamada.
+ * @param altura Altura do rectângulo tocado pela chamada.
+ * @param resultado Valor que a função rastreada devolve.
+ * @return O próprio resultado, para poder ser usado num return.
+ */
+Bool trcSai(int funcao, unsigned long long inicio, int largura, int altura, Bool resultado);
+
+/**
+ * @brief Devolve a unidade das durações: "ciclos", "uclock" ou "ns".
+ */
+const char *trcUnidade(void);
+
+/**
+ * @brief Grava o registo circular num ficheiro CSV, da chamada mais antiga para a mais recente.
+ * Colunas: funcao,inicio_<unidade>,duracao_<unidade>,largura,altura.
+ * @param ficheiro Nome do ficheiro a criar (respeitando os nomes 8.3 do DOS).
+ * @return VERDADE se o ficheiro for gravado, FALSO caso contrário.
+ */
+Bool trcGravaCSV(const char *ficheiro);
+
+/**
+ * @brief Escreve a unidade e p50, p99 e máximo por função e por classe de células.
+ * @param saida Destino do resumo (por exemplo, stdout).
+ */
+void trcResumo(FILE *saida);
+
+#ifdef LC_TRACO
+/** Abre a medição no início de uma função pública de LC_VID */
+#define TRC_ENTRA() unsigned long long inicioTraco = trcEntra()
+/** Fecha a medição e devolve o resultado da função */
+#define TRC_RETORNA(funcao, largura, altura, resultado) \
+    return trcSai((funcao), inicioTraco, (largura), (altura), (resultado))
+#else
+#define TRC_ENTRA()
+/* As dimensões continuam a ser avaliadas (sem custo) para não deixar variáveis sem uso */
+#define TRC_RETORNA(funcao, largura, altura, resultado) \
+    return ((void) (largura), (void) (altura), (resultado))
+#endif
+
+/**@} Fim do grupo LC_TRACO */
+#endif // _LC_TRACO_H_
@@ -1,4 +1,5 @@
 #include "LC_VID.h"
+#include "LC_TRC.h" // Rastreio opcional de latência (activo com -DLC_TRACO)
 #include <go32.h> // Para _dos_ds e _farpokeb, acesso à memória
 #include <sys/farptr.h> // Para _farpokeb
 
@@ -19,9 +20,11 @@
     * @return VERDADE se a impressão for bem-sucedida, falso caso contrário.
  */
  Bool printCharAt(char ch, int x, int y, char atributos) {
+    TRC_ENTRA();
+
     // verifica se as coordenadas estão dentro dos limites do ecrã
     if (x < 0 || x >= LARGURA_LOCAL || y < 0 || y >= ALTURA_LOCAL) {
-        return FALSO; // Posição fora dos limites do ecrã
+        TRC_RETORNA(TRC_PRINTCHARAT, 0, 1, FALSO); // Posição fora dos limites do ecrã
     }
 
     // Calcula o endereço na memória de vídeo
@@ -31,7 +34,7 @@
     _farpokeb(_dos_ds, ENDERECO_VIDEO_LOCAL + offset, ch); // Escreve o caractere
     _farpokeb(_dos_ds, ENDERECO_VIDEO_LOCAL + offset + 1, atributos); // Escreve os atributos
 
-    return VERDADE; // Impressão bem-sucedida
+    TRC_RETORNA(TRC_PRINTCHARAT, 1, 1, VERDADE); // Impressão bem-sucedida
  }
 
  /**
@@ -44,14 +47,17 @@
     * @return VERDADE se a impressão for bem-sucedida, falso caso contrário.
   */
   Bool printStringAt(const char *str, int x, int y, char atributos){
+    const char *origem = str; // Início da cadeia, para contar as células escritas
+    TRC_ENTRA();
+
     //Verificar se a cadeia de caracteres é válida (não é um ponteiro nulo)
     if(str == (const char *) 0){
-        return FALSO; // Cadeia de caracteres inválida
+        TRC_RETORNA(TRC_PRINTSTRINGAT, 0, 1, FALSO); // Cadeia de caracteres inválida
     }
     //Percorre a cadeia até encontrar o caracter de terminação nulo
     while(*str != '\0'){
         if(printCharAt(*str, x, y, atributos) == FALSO){
-            return FALSO; // Falha ao imprimir um caractere
+            TRC_RETORNA(TRC_PRINTSTRINGAT, (int) (str - origem), 1, FALSO); // Falha ao imprimir um caractere
         }
         str++; // Avança para o próximo caractere
         x++;// Avança para a próxima coluna
@@ -62,10 +68,10 @@
         }
 
         if(y >= ALTURA_LOCAL) {
-            return FALSO; // Se y ultrapassar a altura do ecrã, retorna falso
+            TRC_RETORNA(TRC_PRINTSTRINGAT, (int) (str - origem), 1, FALSO); // Se y ultrapassar a altura do ecrã, retorna falso
         }
     }
-    return VERDADE; // Impressão bem-sucedida
+    TRC_RETORNA(TRC_PRINTSTRINGAT, (int) (str - origem), 1, VERDADE); // Impressão bem-sucedida
   }
 
   /**
@@ -84,30 +90,31 @@ Bool drawFrame(const char *titulo, char atributos, int x, int y, int largura, in
      int comprimento_titulo = 0;
      const char *ponteiro_titulo = titulo;
      int posicao_inicio_titulo;
+     TRC_ENTRA();
      if(largura < 2 || altura < 2 || x < 0 || y < 0 || x + largura > LARGURA_LOCAL || y + altura > ALTURA_LOCAL){
-        return FALSO; // Verifica se o quadro está dentro dos limites do ecrã
+        TRC_RETORNA(TRC_DRAWFRAME, 0, 1, FALSO); // Verifica se o quadro está dentro dos limites do ecrã
      }
 
      //Desenha as bordas horizontais (superiores e inferiores)
      for (i = 0; i < largura; i++){
         //Borda superior
         if(printCharAt((i == 0 || i == largura - 1) ? '+' : '-', x + i, y, atributos) == FALSO){
-            return FALSO; // Falha ao imprimir a borda superior
+            TRC_RETORNA(TRC_DRAWFRAME, 2 * (largura + altura) - 4, 1, FALSO); // Falha ao imprimir a borda superior
         }
         //Borda inferior
         if(printCharAt((i == 0 || i == largura - 1) ? '+' : '-', x + i, y + altura - 1, atributos) == FALSO){
-            return FALSO; // Falha ao imprimir a borda inferior
+            TRC_RETORNA(TRC_DRAWFRAME, 2 * (largura + altura) - 4, 1, FALSO); // Falha ao imprimir a borda inferior
         }
      }
      //Desenha as bordas verticais (esquerda e direita)
      for(j = 0; j < altura; j++){
         //Borda esquerda
         if(printCharAt((j == 0 || j == altura - 1) ? '+' : '|', x, y + j, atributos) == FALSO){
-            return FALSO; // Falha ao imprimir a borda esquerda
+            TRC_RETORNA(TRC_DRAWFRAME, 2 * (largura + altura) - 4, 1, FALSO); // Falha ao imprimir a borda esquerda
         }
         //Borda direita
         if(printCharAt((j == 0 || j == altura - 1) ? '+' : '|', x + largura - 1, y + j, atributos) == FALSO){
-            return FALSO; // Falha ao imprimir a borda direita
+            TRC_RETORNA(TRC_DRAWFRAME, 2 * (largura + altura) - 4, 1, FALSO); // Falha ao imprimir a borda direita
         }
      }
         // Se um título for fornecido, desenha-o no topo do quadro
@@ -125,12 +132,12 @@ Bool drawFrame(const char *titulo, char atributos, int x, int y, int largura, in
                 comprimento_titulo = largura - 2; // Garante que o título não ultrapasse a borda direita
             }else{
                 if(printStringAt(titulo, posicao_inicio_titulo, y, atributos) == FALSO){
-                    return FALSO; // Falha ao imprimir o título
+                    TRC_RETORNA(TRC_DRAWFRAME, 2 * (largura + altura) - 4, 1, FALSO); // Falha ao imprimir o título
                 }
             }
            
         }
-         return VERDADE; // Quadro desenhado com sucesso
+         TRC_RETORNA(TRC_DRAWFRAME, 2 * (largura + altura) - 4, 1, VERDADE); // Quadro desenhado com sucesso
 }
 
 /**
@@ -149,14 +156,15 @@ Bool drawFrame(const char *titulo, char atributos, int x, int y, int largura, in
  */
 Bool printCharRepeatedAt(char ch, int contagem, int x, int y, char atributos) {
     int i; // Contador
+    TRC_ENTRA();
     for (i = 0; i < contagem; i++) {
         // Imprimimos o carácter na posição actual e avançamos a coluna.
         // Se printCharAt falhar, a nossa função também falha.
         if (printCharAt(ch, x + i, y, atributos) == FALSO) {
-            return FALSO; // Erro ao imprimir um carácter repetido.
+            TRC_RETORNA(TRC_PRINTCHARREPEATEDAT, contagem, 1, FALSO); // Erro ao imprimir um carácter repetido.
         }
     }
-    return VERDADE; // Operação concluída com sucesso.
+    TRC_RETORNA(TRC_PRINTCHARREPEATEDAT, contagem, 1, VERDADE); // Operação concluída com sucesso.
 }
 
 /**
@@ -178,11 +186,12 @@ remover conteúdo antigo ou preparar áreas para nova informação.
  */
 Bool clearScreen(int x, int y, int largura, int altura, char atributos) {
     int i, j; // Contadores
+    TRC_ENTRA();
 
     // Verificamos se a região a limpar está dentro dos limites do ecrã.
     if (x < 0 || y < 0 || 
         x + largura > LARGURA_LOCAL || y + altura > ALTURA_LOCAL) {
-        return FALSO; // Região inválida.
+        TRC_RETORNA(TRC_CLEARSCREEN, largura, altura, FALSO); // Região inválida.
     }
 
     // Percorremos cada célula da região e escrevemos um espaço com os atributos indicados.
@@ -194,11 +203,11 @@ Bool clearScreen(int x, int y, int largura, int altura, char atributos) {
                 y + j, 
                 atributos
             ) == FALSO) {
-                return FALSO; // Se falhar a limpar um carácter, falha tudo.
+                TRC_RETORNA(TRC_CLEARSCREEN, largura, altura, FALSO); // Se falhar a limpar um carácter, falha tudo.
             }
         }
     }
-    return VERDADE; // Região limpa com sucesso.
+    TRC_RETORNA(TRC_CLEARSCREEN, largura, altura, VERDADE); // Região limpa com sucesso.
 }
 
 /**
@@ -222,18 +231,19 @@ Bool clearScreen(int x, int y, int largura, int altura, char atributos) {
 Bool scrollRegion(int x, int y, int largura, int altura, int linhas, char atributos) {
     int i, j; // Contadores
     unsigned long offset_origem, offset_destino; // Offsets na memória de vídeo
+    TRC_ENTRA();
 
     // Verificamos se a região é válida e se o número de linhas a deslocar é razoável.
     if (x < 0 || y < 0 || 
         x + largura > LARGURA_LOCAL || y + altura > ALTURA_LOCAL ||
         linhas < 0) {
-        return FALSO; // Região ou número de linhas inválido.
+        TRC_RETORNA(TRC_SCROLLREGION, largura, altura, FALSO); // Região ou número de linhas inválido.
     }
 
     // Se o número de linhas a deslocar for maior ou igual à altura da região,
     // significa que toda a região deve ser limpa.
     if (linhas >= altura) {
-        return clearScreen(x, y, largura, altura, atributos); // Limpa a região toda.
+        TRC_RETORNA(TRC_SCROLLREGION, largura, altura, clearScreen(x, y, largura, altura, atributos)); // Limpa a região toda.
     }
 
     // Percorremos as linhas da região, movendo o conteúdo.
@@ -259,10 +269,10 @@ Bool scrollRegion(int x, int y, int largura, int altura, int linhas, char atribu
     for (j = y + altura - linhas; j < y + altura; j++) {
         for (i = x; i < x + largura; i++) {
             if (printCharAt(' ', i, j, atributos) == FALSO) {
-                return FALSO; // Se falhar a limpar, falha tudo.
+                TRC_RETORNA(TRC_SCROLLREGION, largura, altura, FALSO); // Se falhar a limpar, falha tudo.
             }
         }
     }
 
-    return VERDADE; // Operação de scroll concluída com sucesso.
+    TRC_RETORNA(TRC_SCROLLREGION, largura, altura, VERDADE); // Operação de scroll concluída com sucesso.
 }
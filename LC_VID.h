@@ -64,7 +64,7 @@ Bool printCharAt(char ch, int x, int y, char atributos);
     * @return VERDADE se o quadro for desenhado com sucesso, falso caso contrário.
 */
 
-Bool drwaFrame(const char *titulo, char atributos, int x, int y, int largura, int altura);
+Bool drawFrame(const char *titulo, char atributos, int x, int y, int largura, int altura);
 
 /**
     * @brief Imprime o mesmo caracter repetidamente numa linha
@@ -75,7 +75,7 @@ Bool drwaFrame(const char *titulo, char atributos, int x, int y, int largura, in
     * @param atributos Atributos do caractere (cor, intensidade, etc.).
     * @return VERDADE se a impressão for bem-sucedida, falso caso contrário.
  */
- Bool printCharRepeated(char ch, int count, int x, int y, char atributos);
+ Bool printCharRepeatedAt(char ch, int contagem, int x, int y, char atributos);
 
  /**
     * @brief Limpa uma região rectangula do ecrã com um atributo específico
@@ -0,0 +1,769 @@
+#include "LC_WGT.h"
+
+// Tipos de widget guardados na árvore
+#define TIPO_QUADRO 1 // Moldura com título que contém outros widgets
+#define TIPO_ROTULO 2 // Texto fixo de uma linha
+#define TIPO_VALOR 3  // Prefixo seguido de um número alinhado à direita
+#define TIPO_BARRA 4  // Barra de progresso de uma linha
+#define TIPO_LISTA 5  // Lista de itens com um item seleccionado
+
+// Bits do campo 'sujo' de cada widget
+#define SUJO_LAYOUT (1 << 0)  // A posição ou tamanho dos filhos tem de ser recalculada
+#define SUJO_PINTURA (1 << 1) // Todas as células do widget têm de ser repintadas
+#define SUJO_PARCIAL (1 << 2) // Só parte do widget mudou (título de quadro, linhas de lista)
+
+/**
+ * @brief Entrada da árvore de widgets.
+ * Os filhos de um quadro formam uma lista ligada por índices no vector 'widgets',
+ * o que evita alocação dinâmica.
+ */
+typedef struct {
+    Bool emUso;             // VERDADE se a entrada estiver ocupada
+    int tipo;               // Um dos valores TIPO_*
+    int pai;                // Quadro que contém este widget, ou WGT_NENHUM
+    int primeiroFilho;      // Primeiro filho (apenas quadros)
+    int ultimoFilho;        // Último filho, para inserir no fim em tempo constante
+    int proximoIrmao;       // Próximo widget com o mesmo pai
+    const char *texto;      // Título, texto do rótulo ou prefixo do valor
+    const char **itens;     // Itens da lista
+    int contagem;           // Número de itens da lista
+    long valor;             // Valor do contador ou da barra
+    long maximo;            // Valor da barra cheia
+    int seleccao;           // Item seleccionado da lista
+    int linhaPintada;       // Item que está realmente realçado no ecrã
+    int primeiroVisivel;    // Primeiro item mostrado na lista
+    char atributos;         // Atributos de cor e estilo
+    char fundo;             // Atributos das células que a raiz deixa livres (apenas raízes)
+    int orientacao;         // WGT_VERTICAL ou WGT_HORIZONTAL (apenas quadros)
+    int larguraPreferida;   // Largura pedida, ou WGT_PREENCHE
+    int alturaPreferida;    // Altura pedida, ou WGT_PREENCHE
+    int x, y;               // Posição calculada pelo layout
+    int largura, altura;    // Tamanho calculado pelo layout
+    int sujo;               // Combinação de bits SUJO_*
+} Widget;
+
+static Widget widgets[WGT_MAX]; // Todas as entradas da árvore
+
+/**
+ * @brief Verifica se um identificador corresponde a um widget existente.
+ */
+static Bool widgetValido(int id) {
+    return (id >= 0 && id < WGT_MAX && widgets[id].emUso) ? VERDADE : FALSO;
+}
+
+/**
+ * @brief Calcula o comprimento de uma cadeia, aceitando o ponteiro nulo.
+ */
+static int comprimentoTexto(const char *str) {
+    int comprimento = 0;
+    if (str == (const char *) 0) {
+        return 0;
+    }
+    while (str[comprimento] != '\0') {
+        comprimento++;
+    }
+    return comprimento;
+}
+
+/**
+ * @brief Converte um inteiro para texto decimal.
+ * @param valor O número a converter.
+ * @param buffer Destino com pelo menos 12 posições (sem terminador nulo).
+ * @return O número de caracteres escritos.
+ */
+static int inteiroParaTexto(long valor, char *buffer) {
+    char digitos[12];
+    int n = 0, i = 0;
+    unsigned long magnitude = (valor < 0) ? 0UL - (unsigned long) valor : (unsigned long) valor;
+
+    // Extraímos os dígitos do menos para o mais significativo.
+    do {
+        digitos[n++] = (char) ('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0 && n < 11);
+
+    if (valor < 0) {
+        buffer[i++] = '-';
+    }
+    while (n > 0) {
+        buffer[i++] = digitos[--n];
+    }
+    return i;
+}
+
+/**
+ * @brief Troca as cores de frente e de fundo, mantendo a intensidade.
+ */
+static char inverteAtributos(char atributos) {
+    uchar a = (uchar) atributos;
+    return (char) (((a & 0x07) << 4) | ((a >> 4) & 0x07) | (a & INTENSO));
+}
+
+/**
+ * @brief Marca um widget e todos os seus ascendentes para refazer o layout.
+ * Os irmãos cujo rectângulo não mude não são percorridos na próxima actualização.
+ */
+static void marcaLayout(int id) {
+    while (id != WGT_NENHUM) {
+        widgets[id].sujo |= SUJO_LAYOUT;
+        id = widgets[id].pai;
+    }
+}
+
+/**
+ * @brief Reserva uma entrada livre e liga-a ao fim da lista de filhos do pai.
+ * @return Identificador da nova entrada, ou WGT_NENHUM se não houver espaço ou o pai for inválido.
+ */
+static int alocaWidget(int pai, int tipo, char atributos, int largura, int altura) {
+    int id;
+    Widget *w;
+
+    // Só quadros podem conter outros widgets.
+    if (pai != WGT_NENHUM && (widgetValido(pai) == FALSO || widgets[pai].tipo != TIPO_QUADRO)) {
+        return WGT_NENHUM;
+    }
+    if (largura < 0 || altura < 0) {
+        return WGT_NENHUM;
+    }
+
+    for (id = 0; id < WGT_MAX; id++) {
+        if (widgets[id].emUso == FALSO) {
+            break;
+        }
+    }
+    if (id == WGT_MAX) {
+        return WGT_NENHUM; // Árvore cheia
+    }
+
+    w = &widgets[id];
+    w->emUso = VERDADE;
+    w->tipo = tipo;
+    w->pai = pai;
+    w->primeiroFilho = WGT_NENHUM;
+    w->ultimoFilho = WGT_NENHUM;
+    w->proximoIrmao = WGT_NENHUM;
+    w->texto = (const char *) 0;
+    w->itens = (const char **) 0;
+    w->contagem = 0;
+    w->valor = 0;
+    w->maximo = 1;
+    w->seleccao = 0;
+    w->linhaPintada = 0;
+    w->primeiroVisivel = 0;
+    w->atributos = atributos;
+    w->fundo = NORMAL;
+    w->orientacao = WGT_VERTICAL;
+    w->larguraPreferida = largura;
+    w->alturaPreferida = altura;
+    w->x = w->y = 0;
+    w->largura = w->altura = 0;
+    w->sujo = SUJO_LAYOUT | SUJO_PINTURA;
+
+    if (pai != WGT_NENHUM) {
+        if (widgets[pai].ultimoFilho == WGT_NENHUM) {
+            widgets[pai].primeiroFilho = id;
+        } else {
+            widgets[widgets[pai].ultimoFilho].proximoIrmao = id;
+        }
+        widgets[pai].ultimoFilho = id;
+        marcaLayout(pai);
+    }
+    return id;
+}
+
+/**
+ * @brief Devolve a largura que o widget pede ao quadro pai (0 = preencher).
+ */
+static int larguraPedida(const Widget *w) {
+    if (w->tipo == TIPO_ROTULO && w->larguraPreferida == WGT_PREENCHE) {
+        // Um texto vazio não pode pedir 0, que se confundiria com WGT_PREENCHE.
+        int comprimento = comprimentoTexto(w->texto);
+        return (comprimento > 0) ? comprimento : 1;
+    }
+    return w->larguraPreferida;
+}
+
+/**
+ * @brief Devolve a altura que o widget pede ao quadro pai (0 = preencher).
+ */
+static int alturaPedida(const Widget *w) {
+    switch (w->tipo) {
+        case TIPO_ROTULO:
+        case TIPO_VALOR:
+        case TIPO_BARRA:
+            return 1; // Widgets de uma só linha
+        case TIPO_LISTA:
+            if (w->alturaPreferida == WGT_PREENCHE) {
+                return (w->contagem > 0) ? w->contagem : 1; // Nunca 0, que seria WGT_PREENCHE
+            }
+            return w->alturaPreferida;
+        default:
+            return w->alturaPreferida;
+    }
+}
+
+static void dispoe(int id, int x, int y, int largura, int altura);
+
+/**
+ * @brief Distribui o interior de um quadro pelos seus filhos.
+ * No eixo principal, os filhos com tamanho fixo recebem o que pedem e o espaço
+ * restante é repartido pelos filhos com WGT_PREENCHE. No eixo secundário, cada
+ * filho recebe o tamanho pedido, limitado ao interior do quadro.
+ */
+static void dispoeFilhos(int id) {
+    Widget *q = &widgets[id];
+    int interiorX = q->x + 1, interiorY = q->y + 1;
+    int interiorL = q->largura - 2, interiorA = q->altura - 2;
+    int vertical = (q->orientacao == WGT_VERTICAL);
+    int disponivel, fixo = 0, preenchidos = 0, quota = 0, resto = 0, cursor = 0;
+    int filho;
+
+    if (interiorL < 0) interiorL = 0;
+    if (interiorA < 0) interiorA = 0;
+    disponivel = vertical ? interiorA : interiorL;
+
+    // Primeira passagem: somamos o espaço fixo e contamos os filhos elásticos.
+    for (filho = q->primeiroFilho; filho != WGT_NENHUM; filho = widgets[filho].proximoIrmao) {
+        int pedido = vertical ? alturaPedida(&widgets[filho]) : larguraPedida(&widgets[filho]);
+        if (pedido == WGT_PREENCHE) {
+            preenchidos++;
+        } else {
+            fixo += pedido;
+        }
+    }
+    if (preenchidos > 0 && disponivel > fixo) {
+        quota = (disponivel - fixo) / preenchidos;
+        resto = (disponivel - fixo) % preenchidos;
+    }
+
+    // Segunda passagem: atribuímos um rectângulo a cada filho.
+    for (filho = q->primeiroFilho; filho != WGT_NENHUM; filho = widgets[filho].proximoIrmao) {
+        Widget *f = &widgets[filho];
+        int principal = vertical ? alturaPedida(f) : larguraPedida(f);
+        int secundario = vertical ? larguraPedida(f) : alturaPedida(f);
+        int limiteSecundario = vertical ? interiorL : interiorA;
+        int antigoX = f->x, antigoY = f->y, antigaL = f->largura, antigaA = f->altura;
+
+        if (principal == WGT_PREENCHE) {
+            principal = quota;
+            if (--preenchidos == 0) {
+                principal += resto; // O último filho elástico fica com o resto da divisão
+            }
+        }
+        if (principal > disponivel - cursor) {
+            principal = disponivel - cursor; // Cortamos o que não cabe no quadro
+        }
+        if (secundario == WGT_PREENCHE || secundario > limiteSecundario) {
+            secundario = limiteSecundario;
+        }
+
+        if (vertical) {
+            dispoe(filho, interiorX, interiorY + cursor, secundario, principal);
+        } else {
+            dispoe(filho, interiorX + cursor, interiorY, principal, secundario);
+        }
+        cursor += principal;
+
+        // Se um filho mudou de lugar ou de tamanho, as células que ocupava voltam
+        // ao fundo do quadro. Limpamo-las já, antes da pintura, para não apagar
+        // um irmão que entretanto ocupe essa zona; o filho repinta-se no novo sítio.
+        if ((q->sujo & SUJO_PINTURA) == 0 && antigaL > 0 && antigaA > 0 &&
+            (f->x != antigoX || f->y != antigoY || f->largura != antigaL || f->altura != antigaA)) {
+            clearScreen(antigoX, antigoY, antigaL, antigaA, q->atributos);
+        }
+    }
+}
+
+/**
+ * @brief Atribui um rectângulo a um widget e refaz o layout dos seus filhos, se necessário.
+ * Subárvores sem SUJO_LAYOUT cujo rectângulo não mudou são saltadas por completo.
+ */
+static void dispoe(int id, int x, int y, int largura, int altura) {
+    Widget *w = &widgets[id];
+    Bool mudou = (w->x != x || w->y != y || w->largura != largura || w->altura != altura) ? VERDADE : FALSO;
+
+    if (mudou == FALSO && (w->sujo & SUJO_LAYOUT) == 0) {
+        return; // Nada mudou nesta subárvore
+    }
+    if (mudou == VERDADE) {
+        w->sujo |= SUJO_PINTURA;
+    }
+    w->x = x;
+    w->y = y;
+    w->largura = largura;
+    w->altura = altura;
+    w->sujo &= ~SUJO_LAYOUT;
+
+    if (w->tipo == TIPO_QUADRO) {
+        dispoeFilhos(id);
+    }
+}
+
+/**
+ * @brief Escreve texto numa linha com largura fixa, cortando ou completando com espaços.
+ */
+static Bool escreveCampo(const char *texto, int x, int y, int largura, char atributos) {
+    int i;
+    Bool resultado = VERDADE;
+    for (i = 0; i < largura; i++) {
+        char ch = ' ';
+        if (texto != (const char *) 0 && *texto != '\0') {
+            ch = *texto++;
+        }
+        if (printCharAt(ch, x + i, y, atributos) == FALSO) {
+            resultado = FALSO;
+        }
+    }
+    return resultado;
+}
+
+/**
+ * @brief Repinta a borda superior de um quadro e o seu título.
+ * Usa as mesmas regras de centragem que drawFrame.
+ */
+static Bool pintaTopoQuadro(const Widget *w) {
+    int comprimento = comprimentoTexto(w->texto);
+    int inicio = w->x + (w->largura - comprimento) / 2;
+    Bool resultado = VERDADE;
+
+    if (w->largura < 2 || w->altura < 2) {
+        return VERDADE; // Sem espaço para a moldura, tal como em pintaWidget
+    }
+    if (printCharAt('+', w->x, w->y, w->atributos) == FALSO ||
+        printCharRepeatedAt('-', w->largura - 2, w->x + 1, w->y, w->atributos) == FALSO ||
+        printCharAt('+', w->x + w->largura - 1, w->y, w->atributos) == FALSO) {
+        resultado = FALSO;
+    }
+    if (inicio < w->x + 1) {
+        inicio = w->x + 1;
+    }
+    if (comprimento > 0 && inicio + comprimento <= w->x + w->largura - 1) {
+        if (printStringAt(w->texto, inicio, w->y, w->atributos) == FALSO) {
+            resultado = FALSO;
+        }
+    }
+    return resultado;
+}
+
+/**
+ * @brief Repinta uma linha visível de uma lista.
+ */
+static Bool pintaLinhaLista(const Widget *w, int indice) {
+    int linha = indice - w->primeiroVisivel;
+    const char *texto = (const char *) 0;
+    char atributos = w->atributos;
+
+    if (linha < 0 || linha >= w->altura) {
+        return VERDADE; // Item fora da parte visível
+    }
+    if (indice < w->contagem) {
+        texto = w->itens[indice];
+        if (indice == w->seleccao) {
+            atributos = inverteAtributos(w->atributos);
+        }
+    }
+    return escreveCampo(texto, w->x, w->y + linha, w->largura, atributos);
+}
+
+/**
+ * @brief Garante que o item seleccionado está visível.
+ * @return VERDADE se a janela visível da lista teve de se deslocar.
+ */
+static Bool ajustaListaVisivel(Widget *w) {
+    int anterior = w->primeiroVisivel;
+    if (w->seleccao < w->primeiroVisivel) {
+        w->primeiroVisivel = w->seleccao;
+    } else if (w->altura > 0 && w->seleccao >= w->primeiroVisivel + w->altura) {
+        w->primeiroVisivel = w->seleccao - w->altura + 1;
+    }
+    return (w->primeiroVisivel != anterior) ? VERDADE : FALSO;
+}
+
+/**
+ * @brief Pinta todas as células de um widget (sem os filhos de um quadro).
+ */
+static Bool pintaWidget(Widget *w) {
+    char linha[LARGURA + 1];
+    int i, n, cheio;
+    Bool resultado = VERDADE;
+
+    switch (w->tipo) {
+        case TIPO_QUADRO:
+            if (w->largura < 2 || w->altura < 2) {
+                return VERDADE; // Sem espaço para a moldura
+            }
+            if (clearScreen(w->x + 1, w->y + 1, w->largura - 2, w->altura - 2, w->atributos) == FALSO ||
+                drawFrame(w->texto, w->atributos, w->x, w->y, w->largura, w->altura) == FALSO) {
+                resultado = FALSO;
+            }
+            break;
+
+        case TIPO_ROTULO:
+            resultado = escreveCampo(w->texto, w->x, w->y, w->largura, w->atributos);
+            break;
+
+        case TIPO_VALOR:
+            // Prefixo à esquerda, número alinhado à direita; o resto são espaços.
+            n = (w->largura > LARGURA) ? LARGURA : w->largura;
+            for (i = 0; i < n; i++) {
+                linha[i] = ' ';
+            }
+            for (i = 0; i < n && w->texto != (const char *) 0 && w->texto[i] != '\0'; i++) {
+                linha[i] = w->texto[i];
+            }
+            {
+                char numero[12];
+                int digitos = inteiroParaTexto(w->valor, numero);
+                int inicio = (n > digitos) ? n - digitos : 0;
+                for (i = 0; i < digitos && inicio + i < n; i++) {
+                    linha[inicio + i] = numero[i];
+                }
+            }
+            linha[n] = '\0';
+            resultado = escreveCampo(linha, w->x, w->y, w->largura, w->atributos);
+            break;
+
+        case TIPO_BARRA:
+            if (w->valor <= 0) {
+                cheio = 0;
+            } else if (w->valor >= w->maximo) {
+                cheio = w->largura;
+            } else {
+                // Em 64 bits: com long de 32 bits, valor * largura transborda para máximos grandes.
+                cheio = (int) (((unsigned long long) w->valor * (unsigned) w->largura) /
+                               (unsigned long long) w->maximo);
+            }
+            if (printCharRepeatedAt('#', cheio, w->x, w->y, w->atributos) == FALSO ||
+                printCharRepeatedAt('-', w->largura - cheio, w->x + cheio, w->y, w->atributos) == FALSO) {
+                resultado = FALSO;
+            }
+            break;
+
+        case TIPO_LISTA:
+            ajustaListaVisivel(w);
+            for (i = 0; i < w->altura; i++) {
+                if (pintaLinhaLista(w, w->primeiroVisivel + i) == FALSO) {
+                    resultado = FALSO;
+                }
+            }
+            w->linhaPintada = w->seleccao;
+            break;
+    }
+    return resultado;
+}
+
+/**
+ * @brief Repinta apenas o que mudou numa subárvore.
+ * @param id Raiz da subárvore.
+ * @param forcar VERDADE se um ascendente foi repintado e esta subárvore tem de ser redesenhada.
+ */
+static Bool pinta(int id, Bool forcar) {
+    Widget *w = &widgets[id];
+    Bool resultado = VERDADE;
+    int filho;
+
+    if (w->largura <= 0 || w->altura <= 0) {
+        w->sujo &= ~(SUJO_PINTURA | SUJO_PARCIAL);
+        return VERDADE; // Widget sem células no ecrã
+    }
+
+    if (forcar == VERDADE || (w->sujo & SUJO_PINTURA)) {
+        resultado = pintaWidget(w);
+        forcar = (w->tipo == TIPO_QUADRO) ? VERDADE : FALSO;
+    } else if (w->sujo & SUJO_PARCIAL) {
+        if (w->tipo == TIPO_QUADRO) {
+            resultado = pintaTopoQuadro(w);
+        } else if (w->tipo == TIPO_LISTA) {
+            if (ajustaListaVisivel(w) == VERDADE) {
+                resultado = pintaWidget(w); // A lista deslocou-se: todas as linhas mudaram
+            } else {
+                // Só o item que perdeu o realce e o que o ganhou.
+                if (pintaLinhaLista(w, w->linhaPintada) == FALSO ||
+                    pintaLinhaLista(w, w->seleccao) == FALSO) {
+                    resultado = FALSO;
+                }
+                w->linhaPintada = w->seleccao;
+            }
+        }
+    }
+    w->sujo &= ~(SUJO_PINTURA | SUJO_PARCIAL);
+
+    for (filho = w->primeiroFilho; filho != WGT_NENHUM; filho = widgets[filho].proximoIrmao) {
+        if (pinta(filho, forcar) == FALSO) {
+            resultado = FALSO;
+        }
+    }
+    return resultado;
+}
+
+/**
+ * @brief Esvazia a árvore de widgets, libertando todas as entradas.
+ */
+void wgtInicia(void) {
+    int i;
+    for (i = 0; i < WGT_MAX; i++) {
+        widgets[i].emUso = FALSO;
+    }
+}
+
+/**
+ * @brief Cria um quadro (moldura com título) que contém outros widgets.
+ * @param pai Quadro onde o novo quadro é inserido, ou WGT_NENHUM para uma raiz.
+ * @param titulo Título do quadro (opcional, pode ser NULL).
+ * @param atributos Atributos da moldura e do interior.
+ * @param largura Largura preferida, ou WGT_PREENCHE.
+ * @param altura Altura preferida, ou WGT_PREENCHE.
+ * @param orientacao WGT_VERTICAL ou WGT_HORIZONTAL.
+ * @return Identificador do widget, ou WGT_NENHUM em caso de falha.
+ */
+int wgtCriaQuadro(int pai, const char *titulo, char atributos, int largura, int altura, int orientacao) {
+    int id;
+    if (orientacao != WGT_VERTICAL && orientacao != WGT_HORIZONTAL) {
+        return WGT_NENHUM;
+    }
+    id = alocaWidget(pai, TIPO_QUADRO, atributos, largura, altura);
+    if (id != WGT_NENHUM) {
+        widgets[id].texto = titulo;
+        widgets[id].orientacao = orientacao;
+    }
+    return id;
+}
+
+/**
+ * @brief Cria um rótulo de texto com uma linha de altura.
+ * @param pai Quadro onde o rótulo é inserido.
+ * @param texto Texto do rótulo.
+ * @param atributos Atributos do texto.
+ * @param largura Largura preferida, ou WGT_PREENCHE para usar o comprimento do texto.
+ * @return Identificador do widget, ou WGT_NENHUM em caso de falha.
+ */
+int wgtCriaRotulo(int pai, const char *texto, char atributos, int largura) {
+    int id = alocaWidget(pai, TIPO_ROTULO, atributos, largura, 1);
+    if (id != WGT_NENHUM) {
+        widgets[id].texto = texto;
+    }
+    return id;
+}
+
+/**
+ * @brief Cria um valor numérico precedido de um prefixo.
+ * @param pai Quadro onde o valor é inserido.
+ * @param prefixo Texto antes do número (opcional, pode ser NULL).
+ * @param atributos Atributos do texto.
+ * @param largura Largura fixa do widget.
+ * @return Identificador do widget, ou WGT_NENHUM em caso de falha.
+ */
+int wgtCriaValor(int pai, const char *prefixo, char atributos, int largura) {
+    int id;
+    if (largura <= 0) {
+        return WGT_NENHUM; // O contador precisa de uma largura fixa
+    }
+    id = alocaWidget(pai, TIPO_VALOR, atributos, largura, 1);
+    if (id != WGT_NENHUM) {
+        widgets[id].texto = prefixo;
+    }
+    return id;
+}
+
+/**
+ * @brief Cria uma barra de progresso com uma linha de altura.
+ * @param pai Quadro onde a barra é inserida.
+ * @param atributos Atributos da barra.
+ * @param largura Largura preferida, ou WGT_PREENCHE.
+ * @param maximo Valor correspondente à barra cheia.
+ * @return Identificador do widget, ou WGT_NENHUM em caso de falha.
+ */
+int wgtCriaBarra(int pai, char atributos, int largura, long maximo) {
+    int id;
+    if (maximo <= 0) {
+        return WGT_NENHUM;
+    }
+    id = alocaWidget(pai, TIPO_BARRA, atributos, largura, 1);
+    if (id != WGT_NENHUM) {
+        widgets[id].maximo = maximo;
+    }
+    return id;
+}
+
+/**
+ * @brief Cria uma lista de itens com um item seleccionado.
+ * @param pai Quadro onde a lista é inserida.
+ * @param itens Vector de cadeias.
+ * @param contagem Número de itens no vector.
+ * @param atributos Atributos dos itens.
+ * @param largura Largura preferida, ou WGT_PREENCHE.
+ * @param altura Altura preferida, ou WGT_PREENCHE para uma linha por item.
+ * @return Identificador do widget, ou WGT_NENHUM em caso de falha.
+ */
+int wgtCriaLista(int pai, const char **itens, int contagem, char atributos, int largura, int altura) {
+    int id;
+    if (contagem < 0 || (contagem > 0 && itens == (const char **) 0)) {
+        return WGT_NENHUM;
+    }
+    id = alocaWidget(pai, TIPO_LISTA, atributos, largura, altura);
+    if (id != WGT_NENHUM) {
+        widgets[id].itens = itens;
+        widgets[id].contagem = contagem;
+    }
+    return id;
+}
+
+/**
+ * @brief Altera o texto de um rótulo ou o título de um quadro.
+ * Um novo título repinta apenas a borda superior do quadro. Um rótulo cujo
+ * comprimento dependa do texto refaz o layout dos quadros ascendentes.
+ * @return VERDADE se a alteração for aceite, FALSO caso contrário.
+ */
+Bool wgtDefineTexto(int id, const char *texto) {
+    Widget *w;
+    if (widgetValido(id) == FALSO) {
+        return FALSO;
+    }
+    w = &widgets[id];
+    if (w->tipo == TIPO_QUADRO) {
+        w->texto = texto;
+        w->sujo |= SUJO_PARCIAL;
+    } else if (w->tipo == TIPO_ROTULO) {
+        if (w->larguraPreferida == WGT_PREENCHE &&
+            comprimentoTexto(texto) != comprimentoTexto(w->texto)) {
+            marcaLayout(id);
+        }
+        w->texto = texto;
+        w->sujo |= SUJO_PINTURA;
+    } else {
+        return FALSO;
+    }
+    return VERDADE;
+}
+
+/**
+ * @brief Altera o valor de um contador ou de uma barra de progresso.
+ * O tamanho não muda, por isso só as células do próprio widget são repintadas.
+ * @return VERDADE se a alteração for aceite, FALSO caso contrário.
+ */
+Bool wgtDefineValor(int id, long valor) {
+    Widget *w;
+    if (widgetValido(id) == FALSO) {
+        return FALSO;
+    }
+    w = &widgets[id];
+    if (w->tipo != TIPO_VALOR && w->tipo != TIPO_BARRA) {
+        return FALSO;
+    }
+    if (w->valor != valor) {
+        w->valor = valor;
+        w->sujo |= SUJO_PINTURA;
+    }
+    return VERDADE;
+}
+
+/**
+ * @brief Altera os atributos de cor de um widget.
+ * Num quadro, toda a subárvore é repintada porque o interior muda de cor.
+ * @return VERDADE se a alteração for aceite, FALSO caso contrário.
+ */
+Bool wgtDefineAtributos(int id, char atributos) {
+    if (widgetValido(id) == FALSO) {
+        return FALSO;
+    }
+    if (widgets[id].atributos != atributos) {
+        widgets[id].atributos = atributos;
+        widgets[id].sujo |= SUJO_PINTURA;
+    }
+    return VERDADE;
+}
+
+/**
+ * @brief Define os atributos com que são limpas as células que uma raiz deixa
+ * ao mudar de posição ou de tamanho (por omissão, NORMAL).
+ * @return VERDADE se a alteração for aceite, FALSO caso contrário.
+ */
+Bool wgtDefineFundo(int raiz, char atributos) {
+    if (widgetValido(raiz) == FALSO || widgets[raiz].pai != WGT_NENHUM) {
+        return FALSO; // Só as raízes deixam células sem dono
+    }
+    widgets[raiz].fundo = atributos;
+    return VERDADE;
+}
+
+/**
+ * @brief Altera o tamanho preferido de um widget, refazendo o layout dos ascendentes.
+ * @return VERDADE se a alteração for aceite, FALSO caso contrário.
+ */
+Bool wgtDefineTamanho(int id, int largura, int altura) {
+    Widget *w;
+    if (widgetValido(id) == FALSO || largura < 0 || altura < 0) {
+        return FALSO;
+    }
+    w = &widgets[id];
+    if (w->tipo == TIPO_VALOR && largura == WGT_PREENCHE) {
+        return FALSO; // O contador precisa de uma largura fixa
+    }
+    if (w->larguraPreferida != largura || w->alturaPreferida != altura) {
+        w->larguraPreferida = largura;
+        w->alturaPreferida = altura;
+        marcaLayout(id);
+    }
+    return VERDADE;
+}
+
+/**
+ * @brief Selecciona um item de uma lista.
+ * @return VERDADE se a alteração for aceite, FALSO caso contrário.
+ */
+Bool wgtSeleccionaLista(int id, int indice) {
+    Widget *w;
+    if (widgetValido(id) == FALSO || widgets[id].tipo != TIPO_LISTA) {
+        return FALSO;
+    }
+    w = &widgets[id];
+    if (indice < 0 || indice >= w->contagem) {
+        return FALSO;
+    }
+    if (w->seleccao != indice) {
+        w->seleccao = indice;
+        w->sujo |= SUJO_PARCIAL;
+    }
+    return VERDADE;
+}
+
+/**
+ * @brief Refaz o layout das subárvores alteradas e repinta apenas os widgets sujos.
+ * A raiz usa o seu tamanho preferido; WGT_PREENCHE ocupa o ecrã até à margem.
+ * @param raiz Quadro raiz da árvore.
+ * @param x Posição horizontal (coluna) do canto superior esquerdo da raiz.
+ * @param y Posição vertical (linha) do canto superior esquerdo da raiz.
+ * @return VERDADE se a actualização for bem-sucedida, FALSO caso contrário.
+ */
+Bool wgtActualiza(int raiz, int x, int y) {
+    int largura, altura;
+    int antigoX, antigoY, antigaL, antigaA;
+
+    if (widgetValido(raiz) == FALSO || widgets[raiz].pai != WGT_NENHUM ||
+        x < 0 || y < 0 || x >= LARGURA || y >= ALTURA) {
+        return FALSO;
+    }
+
+    largura = larguraPedida(&widgets[raiz]);
+    altura = alturaPedida(&widgets[raiz]);
+    if (largura == WGT_PREENCHE || x + largura > LARGURA) {
+        largura = LARGURA - x;
+    }
+    if (altura == WGT_PREENCHE || y + altura > ALTURA) {
+        altura = ALTURA - y;
+    }
+
+    antigoX = widgets[raiz].x;
+    antigoY = widgets[raiz].y;
+    antigaL = widgets[raiz].largura;
+    antigaA = widgets[raiz].altura;
+    dispoe(raiz, x, y, largura, altura);
+
+    // A raiz não tem quadro pai que limpe as células que deixou: fazemo-lo aqui,
+    // antes da pintura, tal como dispoeFilhos faz para os filhos.
+    if (antigaL > 0 && antigaA > 0 &&
+        (x != antigoX || y != antigoY || largura != antigaL || altura != antigaA)) {
+        clearScreen(antigoX, antigoY, antigaL, antigaA, widgets[raiz].fundo);
+    }
+    return pinta(raiz, FALSO);
+}
@@ -0,0 +1,147 @@
+#ifndef _LC_WIDGETS_H_
+#define _LC_WIDGETS_H_
+
+#include "utypes.h" // Inclui o tipo Bool e outros tipos definidos pelo utilizador
+#include "LC_VID.h" // Primitivas de vídeo usadas para pintar os widgets
+
+/** #defgroup LC_WIDGETS LC_WIDGETS
+ * @{
+ *
+ * Árvore de widgets em modo retido (quadros, rótulos, valores, barras e listas)
+ * com layout e redesenho incrementais sobre as primitivas de LC_VID.
+ *
+ * <pre>
+ * Exemplo de uso:
+ * wgtInicia();
+ * raiz = wgtCriaQuadro(WGT_NENHUM, "CONSOLA", VERDE_FRENTE, 40, 10, WGT_VERTICAL);
+ * contador = wgtCriaValor(raiz, "Pacotes: ", NORMAL, 20);
+ * wgtActualiza(raiz, 0, 0);      // Layout e pintura completos
+ * wgtDefineValor(contador, 42);  // Marca só o contador como sujo
+ * wgtActualiza(raiz, 0, 0);      // Repinta só as células do contador
+ * </pre>
+*/
+
+/** @name Limites e valores especiais da árvore de widgets */
+/*@{*/
+#define WGT_MAX 64          ///< Número máximo de widgets existentes em simultâneo
+#define WGT_NENHUM (-1)     ///< Identificador nulo (sem pai, sem filho, sem irmão)
+#define WGT_PREENCHE 0      ///< Dimensão preferida que ocupa todo o espaço disponível
+/*@}*/
+
+/** @name Orientação da disposição dos filhos de um quadro */
+/*@{*/
+#define WGT_VERTICAL 0      ///< Filhos empilhados de cima para baixo
+#define WGT_HORIZONTAL 1    ///< Filhos dispostos da esquerda para a direita
+/*@}*/
+
+/**
+ * @brief Esvazia a árvore de widgets, libertando todas as entradas.
+ */
+void wgtInicia(void);
+
+/**
+ * @brief Cria um quadro (moldura com título) que contém outros widgets.
+ * @param pai Quadro onde o novo quadro é inserido, ou WGT_NENHUM para uma raiz.
+ * @param titulo Título do quadro (opcional, pode ser NULL).
+ * @param atributos Atributos da moldura e do interior (cor, intensidade, etc.).
+ * @param largura Largura preferida, ou WGT_PREENCHE.
+ * @param altura Altura preferida, ou WGT_PREENCHE.
+ * @param orientacao WGT_VERTICAL ou WGT_HORIZONTAL.
+ * @return Identificador do widget, ou WGT_NENHUM em caso de falha.
+ */
+int wgtCriaQuadro(int pai, const char *titulo, char atributos, int largura, int altura, int orientacao);
+
+/**
+ * @brief Cria um rótulo de texto com uma linha de altura.
+ * @param pai Quadro onde o rótulo é inserido.
+ * @param texto Texto do rótulo (a cadeia não é copiada e tem de continuar válida).
+ * @param atributos Atributos do texto.
+ * @param largura Largura preferida, ou WGT_PREENCHE para usar o comprimento do texto.
+ * @return Identificador do widget, ou WGT_NENHUM em caso de falha.
+ */
+int wgtCriaRotulo(int pai, const char *texto, char atributos, int largura);
+
+/**
+ * @brief Cria um valor numérico precedido de um prefixo (contador).
+ * @param pai Quadro onde o valor é inserido.
+ * @param prefixo Texto antes do número (opcional, pode ser NULL).
+ * @param atributos Atributos do texto.
+ * @param largura Largura fixa do widget; o número é alinhado à direita.
+ * @return Identificador do widget, ou WGT_NENHUM em caso de falha.
+ */
+int wgtCriaValor(int pai, const char *prefixo, char atributos, int largura);
+
+/**
+ * @brief Cria uma barra de progresso com uma linha de altura.
+ * @param pai Quadro onde a barra é inserida.
+ * @param atributos Atributos da barra.
+ * @param largura Largura preferida, ou WGT_PREENCHE.
+ * @param maximo Valor correspondente à barra cheia (maior que zero).
+ * @return Identificador do widget, ou WGT_NENHUM em caso de falha.
+ */
+int wgtCriaBarra(int pai, char atributos, int largura, long maximo);
+
+/**
+ * @brief Cria uma lista de itens com um item seleccionado.
+ * @param pai Quadro onde a lista é inserida.
+ * @param itens Vector de cadeias (não é copiado e tem de continuar válido).
+ * @param contagem Número de itens no vector.
+ * @param atributos Atributos dos itens; o item seleccionado usa as cores invertidas.
+ * @param largura Largura preferida, ou WGT_PREENCHE.
+ * @param altura Altura preferida, ou WGT_PREENCHE para uma linha por item.
+ * @return Identificador do widget, ou WGT_NENHUM em caso de falha.
+ */
+int wgtCriaLista(int pai, const char **itens, int contagem, char atributos, int largura, int altura);
+
+/**
+ * @brief Altera o texto de um rótulo ou o título de um quadro.
+ * Se o tamanho preferido mudar, o layout dos quadros ascendentes é refeito.
+ * @return VERDADE se a alteração for aceite, FALSO caso contrário.
+ */
+Bool wgtDefineTexto(int id, const char *texto);
+
+/**
+ * @brief Altera o valor de um contador ou de uma barra de progresso.
+ * Só as células do próprio widget são repintadas na próxima actualização.
+ * @return VERDADE se a alteração for aceite, FALSO caso contrário.
+ */
+Bool wgtDefineValor(int id, long valor);
+
+/**
+ * @brief Altera os atributos de cor de um widget.
+ * @return VERDADE se a alteração for aceite, FALSO caso contrário.
+ */
+Bool wgtDefineAtributos(int id, char atributos);
+
+/**
+ * @brief Define o fundo do ecrã à volta de uma raiz (por exemplo, AZUL_FUNDO).
+ * As células que a raiz deixa ao mudar de posição ou de tamanho são limpas
+ * com estes atributos; por omissão usa-se NORMAL.
+ * @return VERDADE se a alteração for aceite, FALSO caso contrário.
+ */
+Bool wgtDefineFundo(int raiz, char atributos);
+
+/**
+ * @brief Altera o tamanho preferido de um widget, refazendo o layout dos ascendentes.
+ * @return VERDADE se a alteração for aceite, FALSO caso contrário.
+ */
+Bool wgtDefineTamanho(int id, int largura, int altura);
+
+/**
+ * @brief Selecciona um item de uma lista.
+ * Apenas as linhas do item anterior e do novo item são repintadas.
+ * @return VERDADE se a alteração for aceite, FALSO caso contrário.
+ */
+Bool wgtSeleccionaLista(int id, int indice);
+
+/**
+ * @brief Refaz o layout das subárvores alteradas e repinta apenas os widgets sujos.
+ * @param raiz Quadro raiz da árvore.
+ * @param x Posição horizontal (coluna) do canto superior esquerdo da raiz.
+ * @param y Posição vertical (linha) do canto superior esquerdo da raiz.
+ * @return VERDADE se a actualização for bem-sucedida, FALSO caso contrário.
+ */
+Bool wgtActualiza(int raiz, int x, int y);
+
+/**@} Fim do grupo LC_WIDGETS */
+#endif // _LC_WIDGETS_H_
@@ -2,6 +2,7 @@
 #include <stdlib.h> 
 #include "LC_VID.h" 
 #include "utypes.h" 
+#include "LC_TRC.h" 
 
 /**
  * @mainpage Documentação do Projecto Trabalho 1 em Grupo
@@ -307,5 +308,17 @@ int main()
     // printf("\nFim da demonstração. Pressione qualquer tecla para sair...\n");
     // getchar(); // Esperar por tecla final.
 
+#ifdef LC_TRACO
+    // Gravamos as chamadas rastreadas e o resumo em ficheiros, para não sujar o ecrã.
+    trcGravaCSV("TRACO.CSV");
+    {
+        FILE *resumo = fopen("RESUMO.TXT", "w");
+        if (resumo != (FILE *) 0) {
+            trcResumo(resumo);
+            fclose(resumo);
+        }
+    }
+#endif
+
     return 0; // Saída bem-sucedida.
 }